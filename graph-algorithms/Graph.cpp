@@ -12,12 +12,290 @@
 #include <algorithm>
 #include <limits>
 #include <cstddef>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
 using namespace std;
 
-Graph::Graph(const char* const & edgelist_csv_fn) {
+/** Marks a missing node, such as the parent of a path's start. */
+const unsigned int NO_NODE = numeric_limits<unsigned int>::max();
+
+const string ORDERING_NAMES[] = {"none", "degree", "rcm", "bfs", "gorder"};
+
+const string COMPRESSION_NAMES[] = {"none", "varint", "q32", "q16"};
+
+/** How many recently placed nodes the Gorder window considers. */
+const unsigned int GORDER_WINDOW = 5;
+
+/** Nodes with more neighbors than this are not expanded when scoring Gorder siblings. */
+const unsigned int GORDER_HUB_DEGREE = 256;
+
+bool Graph::parse_ordering(string const & name, Ordering & ordering) {
+    for(unsigned int i = 0; i < sizeof(ORDERING_NAMES)/sizeof(string); ++i){
+        if(name.compare(ORDERING_NAMES[i]) == 0){
+            ordering = static_cast<Ordering>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+string Graph::ordering_name(Ordering ordering) {
+    return ORDERING_NAMES[ordering];
+}
+
+bool Graph::parse_compression(string const & name, Compression & compression) {
+    for(unsigned int i = 0; i < sizeof(COMPRESSION_NAMES)/sizeof(string); ++i){
+        if(name.compare(COMPRESSION_NAMES[i]) == 0){
+            compression = static_cast<Compression>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+string Graph::compression_name(Compression compression) {
+    return COMPRESSION_NAMES[compression];
+}
+
+/**
+ * Append `value` to `bytes` as a varint: 7 bits per byte, low bits first, with the
+ * high bit set on every byte but the last.
+ */
+void encodeVarint(unsigned int value, vector<unsigned char> & bytes) {
+    while(value >= 0x80){
+        bytes.push_back(static_cast<unsigned char>(value | 0x80));
+        value >>= 7;
+    }
+    bytes.push_back(static_cast<unsigned char>(value));
+}
+
+/**
+ * Return the nodes sorted by decreasing degree, breaking ties by ID.
+ */
+vector<unsigned int> degreeOrder(vector<unsigned int> const & offsets) {
+    unsigned int numNodes = offsets.size() - 1;
+    vector<unsigned int> order(numNodes);
+    for(unsigned int u = 0; u < numNodes; ++u){
+        order[u] = u;
+    }
+    stable_sort(order.begin(), order.end(), [&](unsigned int first, unsigned int second){
+        return offsets[first+1] - offsets[first] > offsets[second+1] - offsets[second];
+    });
+    return order;
+}
+
+/**
+ * Return the nodes in the order a BFS discovers them, restarting from the lowest
+ * unvisited ID for each connected component.
+ */
+vector<unsigned int> bfsOrder(vector<unsigned int> const & offsets, vector<unsigned int> const & targets) {
+    unsigned int numNodes = offsets.size() - 1;
+    vector<unsigned int> order;
+    vector<bool> visited(numNodes, false);
+
+    for(unsigned int start = 0; start < numNodes; ++start){
+        if(visited[start]){
+            continue;
+        }
+        visited[start] = true;
+        order.push_back(start);
+
+        //the order vector doubles as the BFS queue
+        for(unsigned int head = order.size() - 1; head < order.size(); ++head){
+            unsigned int currentNode = order[head];
+            for(unsigned int i = offsets[currentNode]; i < offsets[currentNode+1]; ++i){
+                if(!visited[targets[i]]){
+                    visited[targets[i]] = true;
+                    order.push_back(targets[i]);
+                }
+            }
+        }
+    }
+    return order;
+}
+
+/**
+ * Return the Reverse Cuthill-McKee order: a BFS from a minimum degree node of each
+ * component that visits neighbors in increasing degree, reversed at the end.
+ */
+vector<unsigned int> rcmOrder(vector<unsigned int> const & offsets, vector<unsigned int> const & targets) {
+    unsigned int numNodes = offsets.size() - 1;
+    vector<unsigned int> order;
+    vector<bool> visited(numNodes, false);
+    vector<unsigned int> frontier;
+
+    auto degreeLess = [&](unsigned int first, unsigned int second){
+        unsigned int firstDegree = offsets[first+1] - offsets[first];
+        unsigned int secondDegree = offsets[second+1] - offsets[second];
+        if(firstDegree != secondDegree){
+            return firstDegree < secondDegree;
+        }
+        return first < second;
+    };
+
+    vector<unsigned int> byDegree(numNodes);
+    for(unsigned int u = 0; u < numNodes; ++u){
+        byDegree[u] = u;
+    }
+    sort(byDegree.begin(), byDegree.end(), degreeLess);
+
+    for(unsigned int start : byDegree){
+        if(visited[start]){
+            continue;
+        }
+        visited[start] = true;
+        order.push_back(start);
+
+        for(unsigned int head = order.size() - 1; head < order.size(); ++head){
+            unsigned int currentNode = order[head];
+            frontier.clear();
+            for(unsigned int i = offsets[currentNode]; i < offsets[currentNode+1]; ++i){
+                if(!visited[targets[i]]){
+                    visited[targets[i]] = true;
+                    frontier.push_back(targets[i]);
+                }
+            }
+            sort(frontier.begin(), frontier.end(), degreeLess);
+            order.insert(order.end(), frontier.begin(), frontier.end());
+        }
+    }
+
+    reverse(order.begin(), order.end());
+    return order;
+}
+
+/**
+ * Return a Gorder-style order. Nodes are placed greedily: the next node is the one with
+ * the most edges to, and shared neighbors with, the last `GORDER_WINDOW` placed nodes.
+ * When no unplaced node scores above zero, the highest degree unplaced node is taken.
+ */
+vector<unsigned int> gorderOrder(vector<unsigned int> const & offsets, vector<unsigned int> const & targets) {
+    unsigned int numNodes = offsets.size() - 1;
+    vector<unsigned int> byDegree = degreeOrder(offsets);
+    unsigned int nextByDegree = 0;
+    vector<unsigned int> order;
+    vector<bool> placed(numNodes, false);
+    vector<unsigned int> scores(numNodes, 0);
+    queue<unsigned int> window;
+
+    //unplaced nodes with a positive score sit in a doubly linked bucket per score, so a score
+    //changes in O(1); topScore may be above the highest non-empty bucket and is lowered lazily
+    vector<unsigned int> bucketHeads(1, NO_NODE);
+    vector<unsigned int> previous(numNodes, NO_NODE);
+    vector<unsigned int> next(numNodes, NO_NODE);
+    unsigned int topScore = 0;
+
+    auto unlink = [&](unsigned int node){
+        if(previous[node] != NO_NODE){
+            next[previous[node]] = next[node];
+        }
+        else{
+            bucketHeads[scores[node]] = next[node];
+        }
+        if(next[node] != NO_NODE){
+            previous[next[node]] = previous[node];
+        }
+    };
+
+    auto link = [&](unsigned int node){
+        unsigned int score = scores[node];
+        if(score >= bucketHeads.size()){
+            bucketHeads.resize(score + 1, NO_NODE);
+        }
+        previous[node] = NO_NODE;
+        next[node] = bucketHeads[score];
+        if(next[node] != NO_NODE){
+            previous[next[node]] = node;
+        }
+        bucketHeads[score] = node;
+        topScore = max(topScore, score);
+    };
+
+    //a node's score only drops after the node that raised it leaves the window, so it never goes negative
+    auto addScore = [&](unsigned int node, int delta){
+        if(!placed[node]){
+            if(scores[node] > 0){
+                unlink(node);
+            }
+            scores[node] += delta;
+            if(scores[node] > 0){
+                link(node);
+            }
+        }
+    };
+
+    //a node entering or leaving the window changes the score of its neighbors and siblings
+    auto updateWindow = [&](unsigned int node, int delta){
+        for(unsigned int i = offsets[node]; i < offsets[node+1]; ++i){
+            unsigned int neighbor = targets[i];
+            addScore(neighbor, delta);
+            if(offsets[neighbor+1] - offsets[neighbor] > GORDER_HUB_DEGREE){
+                continue;
+            }
+            for(unsigned int j = offsets[neighbor]; j < offsets[neighbor+1]; ++j){
+                if(targets[j] != node){
+                    addScore(targets[j], delta);
+                }
+            }
+        }
+    };
+
+    while(order.size() < numNodes){
+        while(topScore > 0 && bucketHeads[topScore] == NO_NODE){
+            --topScore;
+        }
+
+        unsigned int chosen;
+        if(topScore > 0){
+            chosen = bucketHeads[topScore];
+            unlink(chosen);
+        }
+        else{
+            while(placed[byDegree[nextByDegree]]){
+                ++nextByDegree;
+            }
+            chosen = byDegree[nextByDegree];
+        }
+
+        placed[chosen] = true;
+        order.push_back(chosen);
+        updateWindow(chosen, 1);
+        window.push(chosen);
+        if(window.size() > GORDER_WINDOW){
+            updateWindow(window.front(), -1);
+            window.pop();
+        }
+    }
+    return order;
+}
+
+bool Graph::edgeLess(Edge const & first, Edge const & second) {
+    return first.from != second.from ? first.from < second.from : first.to < second.to;
+}
+
+void Graph::sortEdges(vector<Edge> & edges) {
+    stable_sort(edges.begin(), edges.end(), edgeLess);
+
+    //a repeated pair keeps the weight from the last line that gave it
+    size_t kept = 0;
+    for(Edge const & edge : edges){
+        if(kept > 0 && edges[kept-1].from == edge.from && edges[kept-1].to == edge.to){
+            edges[kept-1].weight = edge.weight;
+        }
+        else{
+            edges[kept++] = edge;
+        }
+    }
+    edges.resize(kept);
+}
+
+Graph::Graph(const char* const & edgelist_csv_fn, Ordering ordering, Compression compression)
+    : compression(COMPRESS_NONE), weightBase(0), weightStep(0), edgeCount(0) {
     // TODO
     ifstream edgeListCSV(edgelist_csv_fn);                  // open the file
     string line;                                            // helper var to store current line
+    vector<Edge> edges;                                     // both directions of every edge, by load order ID
     while(getline(edgeListCSV, line)) {                     // read one line from the file
         istringstream ss(line);                             // create istringstream of current line
         string first, second, third;                        // helper vars
@@ -27,136 +305,314 @@ Graph::Graph(const char* const & edgelist_csv_fn) {
 
         double edgeWeight = stod(third);
 
-        adjacencyList[first][second] = edgeWeight;
-        adjacencyList[second][first] = edgeWeight;
+        // IDs are handed out in order of first appearance
+        auto firstID = ids.emplace(first, labels.size());
+        if(firstID.second){
+            labels.push_back(first);
+        }
+        auto secondID = ids.emplace(second, labels.size());
+        if(secondID.second){
+            labels.push_back(second);
+        }
+
+        Edge forward = {firstID.first->second, secondID.first->second, edgeWeight};
+        Edge backward = {secondID.first->second, firstID.first->second, edgeWeight};
+        edges.push_back(forward);
+        edges.push_back(backward);
     }
     edgeListCSV.close();                                    // close file when done
+    sortEdges(edges);
+
+    //the load order is the identity ordering, so only the other orderings relabel
+    unsigned int numNodes = labels.size();
+    if(ordering != ORDER_NONE){
+        vector<unsigned int> loadOffsets(numNodes + 1, 0);
+        vector<unsigned int> loadTargets;
+        loadTargets.reserve(edges.size());
+        for(Edge const & edge : edges){
+            ++loadOffsets[edge.from + 1];
+            loadTargets.push_back(edge.to);
+        }
+        for(unsigned int u = 0; u < numNodes; ++u){
+            loadOffsets[u+1] += loadOffsets[u];
+        }
+
+        vector<unsigned int> order;                         // order[newID] = load order ID
+        if(ordering == ORDER_DEGREE){
+            order = degreeOrder(loadOffsets);
+        }
+        else if(ordering == ORDER_RCM){
+            order = rcmOrder(loadOffsets, loadTargets);
+        }
+        else if(ordering == ORDER_BFS){
+            order = bfsOrder(loadOffsets, loadTargets);
+        }
+        else{
+            order = gorderOrder(loadOffsets, loadTargets);
+        }
+        vector<unsigned int>().swap(loadTargets);
+
+        //relabel the nodes and the edges, then put the edges back in row order
+        vector<string> loadLabels;
+        loadLabels.swap(labels);
+        labels.resize(numNodes);
+        vector<unsigned int> newIDs(numNodes);
+        for(unsigned int u = 0; u < numNodes; ++u){
+            newIDs[order[u]] = u;
+            labels[u].swap(loadLabels[order[u]]);
+            ids[labels[u]] = u;
+        }
+        for(Edge & edge : edges){
+            edge.from = newIDs[edge.from];
+            edge.to = newIDs[edge.to];
+        }
+        sort(edges.begin(), edges.end(), edgeLess);
+    }
+
+    buildRows(edges, compression);
+}
+
+void Graph::buildRows(vector<Edge> const & edges, Compression mode) {
+    unsigned int numNodes = labels.size();
+    compression = mode;
+    edgeCount = edges.size() / 2;
+    offsets.assign(numNodes + 1, 0);
+
+    //the edges are already sorted by row and then by neighbor, so only the row offsets need counting
+    if(mode == COMPRESS_NONE){
+        for(Edge const & edge : edges){
+            ++offsets[edge.from + 1];
+        }
+        for(unsigned int u = 0; u < numNodes; ++u){
+            offsets[u+1] += offsets[u];
+        }
+
+        targets.reserve(edges.size());
+        weights.reserve(edges.size());
+        for(Edge const & edge : edges){
+            targets.push_back(edge.to);
+            weights.push_back(edge.weight);
+        }
+        return;
+    }
+
+    //quantize the weights evenly between the smallest and largest weight
+    double levels = (mode == COMPRESS_VARINT_Q16) ? numeric_limits<uint16_t>::max() : numeric_limits<uint32_t>::max();
+    if(mode != COMPRESS_VARINT && !edges.empty()){
+        double maxWeight = edges[0].weight;
+        weightBase = edges[0].weight;
+        for(Edge const & edge : edges){
+            weightBase = min(weightBase, edge.weight);
+            maxWeight = max(maxWeight, edge.weight);
+        }
+        weightStep = (maxWeight - weightBase) / levels;
+    }
+
+    auto appendWeight = [&](double weight){
+        unsigned char raw[sizeof(double)];
+        size_t width = sizeof(double);
+        if(mode == COMPRESS_VARINT){
+            memcpy(raw, &weight, width);
+        }
+        else{
+            double level = (weightStep > 0) ? min(levels, floor((weight - weightBase) / weightStep + 0.5)) : 0;
+            if(mode == COMPRESS_VARINT_Q16){
+                uint16_t level16 = static_cast<uint16_t>(level);
+                width = sizeof(level16);
+                memcpy(raw, &level16, width);
+            }
+            else{
+                uint32_t level32 = static_cast<uint32_t>(level);
+                width = sizeof(level32);
+                memcpy(raw, &level32, width);
+            }
+        }
+        encodedNeighbors.insert(encodedNeighbors.end(), raw, raw + width);
+    };
+
+    //gap-encode each row with its weights; the first neighbor is stored relative to the node itself
+    auto gapAt = [&](size_t i){
+        unsigned int neighbor = edges[i].to;
+        if(i == 0 || edges[i-1].from != edges[i].from){
+            unsigned int u = edges[i].from;
+            return (neighbor >= u) ? (neighbor - u) << 1 : ((u - neighbor - 1) << 1) | 1;
+        }
+        return neighbor - edges[i-1].to;
+    };
+
+    //size the encoding exactly first, so it is never over-allocated or copied
+    size_t weightWidth = (mode == COMPRESS_VARINT) ? sizeof(double) : (mode == COMPRESS_VARINT_Q16) ? sizeof(uint16_t) : sizeof(uint32_t);
+    size_t encodedSize = edges.size() * weightWidth;
+    for(size_t i = 0; i < edges.size(); ++i){
+        for(unsigned int gap = gapAt(i); gap >= 0x80; gap >>= 7){
+            ++encodedSize;
+        }
+        ++encodedSize;
+    }
+
+    //the row offsets are only valid if the whole encoding fits in an unsigned int
+    if(encodedSize > numeric_limits<unsigned int>::max()){
+        throw length_error("compressed adjacency is larger than 4 GB");
+    }
+    encodedNeighbors.reserve(encodedSize);
+
+    size_t i = 0;
+    for(unsigned int u = 0; u < numNodes; ++u){
+        offsets[u] = encodedNeighbors.size();
+        for(; i < edges.size() && edges[i].from == u; ++i){
+            encodeVarint(gapAt(i), encodedNeighbors);
+            appendWeight(edges[i].weight);
+        }
+    }
+    offsets[numNodes] = encodedNeighbors.size();
 }
 
 unsigned int Graph::num_nodes() {
     // TODO
-    return adjacencyList.size();
+    return labels.size();
 }
 
 vector<string> Graph::nodes() {
     // TODO
-    vector<string> nodes;
-    for(auto& pair : adjacencyList){
-        nodes.push_back(pair.first);
-    }
-    return nodes;
+    return labels;
 }
 
 unsigned int Graph::num_edges() {
     // TODO
-    int numEdges = 0;
-    for(auto& pair : adjacencyList){
-        numEdges += pair.second.size();
-    }
-    return numEdges / 2;
+    return edgeCount;
 }
 
 unsigned int Graph::num_neighbors(string const & node_label) {
     // TODO
-    int numOfNeighbors = 0;
-    for(auto& pair : adjacencyList){
-        if(node_label.compare(pair.first) == 0){
-            return pair.second.size();
-        }
+    auto found = ids.find(node_label);
+    if(found != ids.end() && compression == COMPRESS_NONE){
+        return offsets[found->second + 1] - offsets[found->second];
+    }
+
+    //compressed rows do not record their length, so count them
+    if(found != ids.end()){
+        unsigned int count = 0;
+        forEachNeighbor(found->second, [&](unsigned int, double){
+            ++count;
+        });
+        return count;
     }
 
-    return numOfNeighbors;
+    return 0;
 }
 
 double Graph::edge_weight(string const & u_label, string const & v_label) {
     // TODO
-    unordered_map<string, double> listOfNeighbors = adjacencyList.at(u_label);
-    if(listOfNeighbors.find(v_label) != listOfNeighbors.end()){
-        double neighborEdgeWeight = listOfNeighbors.at(v_label);
-        return neighborEdgeWeight;
+    unsigned int u = ids.at(u_label);
+    auto found = ids.find(v_label);
+    if(found == ids.end()){
+        return -1;
     }
 
+    if(compression == COMPRESS_NONE){
+        //the neighbors of u are sorted by ID, so binary search for v
+        auto rowStart = targets.begin() + offsets[u];
+        auto rowEnd = targets.begin() + offsets[u+1];
+        auto neighbor = lower_bound(rowStart, rowEnd, found->second);
+        if(neighbor != rowEnd && *neighbor == found->second){
+            return weights[neighbor - targets.begin()];
+        }
+        return -1;
+    }
+
+    //compressed rows can only be decoded in order, but they are sorted, so stop once v is passed
+    const unsigned char* bytes = encodedNeighbors.data() + offsets[u];
+    const unsigned char* rowEnd = encodedNeighbors.data() + offsets[u+1];
+    unsigned int neighbor = u;
+    for(bool firstInRow = true; bytes < rowEnd; firstInRow = false){
+        neighbor = nextNeighbor(u, firstInRow, neighbor, bytes);
+        double weight = nextWeight(bytes);
+        if(neighbor >= found->second){
+            return (neighbor == found->second) ? weight : -1;
+        }
+    }
     return -1;
 }
 
+size_t Graph::adjacency_bytes() {
+    return offsets.size() * sizeof(unsigned int)
+        + targets.size() * sizeof(unsigned int)
+        + weights.size() * sizeof(double)
+        + encodedNeighbors.size();
+}
+
+double Graph::max_weight_error() {
+    if(compression == COMPRESS_VARINT_Q32 || compression == COMPRESS_VARINT_Q16){
+        return weightStep / 2;
+    }
+    return 0;
+}
+
 vector<string> Graph::neighbors(string const & node_label) {
     // TODO
     vector<string> neighbors;
-    unordered_map<string,double> listOfNeighbors = adjacencyList.at(node_label);
-    for(pair<string,double> pairs : listOfNeighbors){
-        neighbors.push_back(pairs.first);
-    }
+    forEachNeighbor(ids.at(node_label), [&](unsigned int neighbor, double){
+        neighbors.push_back(labels[neighbor]);
+    });
     return neighbors;
 }
 
 vector<string> Graph::shortest_path_unweighted(string const & start_label, string const & end_label) {
     // TODO
-    queue<pair<string,int>> bfsQueue;
-    unordered_map<string, string> parent;                   //array to store parents of nodes
-    unordered_map<string, int> distances;                   //keeps track of distances via current node
-    set<string> visited;
+    unsigned int start = ids.at(start_label);
+    auto found = ids.find(end_label);
+    if(found == ids.end()){
+        return vector<string>();
+    }
+    unsigned int end = found->second;
+
+    queue<unsigned int> bfsQueue;
+    vector<unsigned int> parent(labels.size(), NO_NODE);   //array to store parents of nodes
+    vector<bool> visited(labels.size(), false);
     vector<string> path; 
-    bfsQueue.push(make_pair(start_label, 0));
-    visited.insert(start_label);
-    distances[start_label] = 0;
+    bfsQueue.push(start);
+    visited[start] = true;
     
     while(!bfsQueue.empty()){
-        pair<string, int> currentNodeAndDist = bfsQueue.front();
+        unsigned int currentNode = bfsQueue.front();
         bfsQueue.pop();
-        string currentNode = currentNodeAndDist.first;
-        int currentDist = currentNodeAndDist.second;
-        distances[currentNode] = currentDist;
 
-        if(currentNode.compare(end_label) == 0){
+        if(currentNode == end){
 
-            stack<string> reversedPath;
-            string revPathName = currentNode;
+            stack<unsigned int> reversedPath;
+            unsigned int revPathNode = currentNode;
 
-            while(revPathName.compare("") != 0){
-                reversedPath.push(revPathName);
-                revPathName = parent[revPathName];
+            while(revPathNode != NO_NODE){
+                reversedPath.push(revPathNode);
+                revPathNode = parent[revPathNode];
             }
 
             while(!reversedPath.empty()){
-                string startToEnd = reversedPath.top();
+                path.push_back(labels[reversedPath.top()]);
                 reversedPath.pop();
-                path.push_back(startToEnd);
             }
 
             return path;
         }
 
-        //find the neighbors
-        vector<string> neighborVector = neighbors(currentNode);
-        for(string nbr : neighborVector){
-
-            //if the neighbor wasn't visited, visit it and add it to the queue
-            if(visited.find(nbr) == visited.end()){
-                visited.insert(nbr);
-                bfsQueue.push(make_pair(nbr, currentDist + 1));
-                if(parent[nbr].compare("") == 0){
-                    parent[nbr] = currentNode;
-                }
-
-                distances[nbr] = currentDist + 1;
+        //if the neighbor wasn't visited, visit it and add it to the queue
+        forEachNeighbor(currentNode, [&](unsigned int nbr, double){
+            if(!visited[nbr]){
+                visited[nbr] = true;
+                parent[nbr] = currentNode;
+                bfsQueue.push(nbr);
             }
-        }
+        });
     }
 
-    //we reached the end vertex, so reconstruct the path
+    //we never reached the end vertex, so there is no path
     vector<string> empty;
     return empty;
 }
 
 vector<tuple<string,string,double>> Graph::shortest_path_weighted(string const & start_label, string const & end_label) {
     // TODO
-    priority_queue<pair<double, string>, vector<pair<double, string>>, greater<pair<double,string>>> dijkstraPQ;
-
-    unordered_map<string, string> parent;                   //array to store parents of nodes
-    unordered_map<string, double> totalDistances;           //keeps track of total distance via current node as index 
-    unordered_map<string, double> singleEdgeWeights;        //keeps track of the individual edge weights.
-    set<string> visited;
-    vector<tuple<string,string,double>> path;
+    priority_queue<pair<double, unsigned int>, vector<pair<double, unsigned int>>, greater<pair<double, unsigned int>>> dijkstraPQ;
 
     //if the start and end are the same, return one tuple
     if(start_label.compare(end_label) == 0){
@@ -165,46 +621,49 @@ vector<tuple<string,string,double>> Graph::shortest_path_weighted(string const &
         return sameStartEnd;
     }
 
-    //make all the distances infinity and no parents yet
-    for(auto& pairing : adjacencyList){
-        totalDistances[pairing.first] = numeric_limits<double>::max();
-        parent[pairing.first] = "";
+    unsigned int start = ids.at(start_label);
+    auto found = ids.find(end_label);
+    if(found == ids.end()){
+        return vector<tuple<string,string,double>>();
     }
+    unsigned int end = found->second;
+
+    //make all the distances infinity and no parents yet
+    vector<unsigned int> parent(labels.size(), NO_NODE);   //array to store parents of nodes
+    vector<double> totalDistances(labels.size(), numeric_limits<double>::max());    //total distance via current node as index
+    vector<double> singleEdgeWeights(labels.size(), -1);   //keeps track of the weight of the edge from each parent
+    vector<bool> visited(labels.size(), false);
+    vector<tuple<string,string,double>> path;
 
     //set start to 0 and push to pq
-    totalDistances[start_label] = 0;
-    dijkstraPQ.push(make_pair(0, start_label));
+    totalDistances[start] = 0;
+    dijkstraPQ.push(make_pair(0, start));
 
     while(!dijkstraPQ.empty()){
-        pair<double, string> currentNodeAndDist = dijkstraPQ.top();
+        pair<double, unsigned int> currentNodeAndDist = dijkstraPQ.top();
         dijkstraPQ.pop();
         double currentTotalWeight = currentNodeAndDist.first;
-        string currentName = currentNodeAndDist.second;
+        unsigned int currentNode = currentNodeAndDist.second;
 
-        if(visited.find(currentName) == visited.end()){
-            visited.insert(currentName);
+        if(!visited[currentNode]){
+            visited[currentNode] = true;
 
-            for(auto& listOfNeighbors : adjacencyList.at(currentName)){
-                string neighborName = listOfNeighbors.first;
-                double neighborWeight = listOfNeighbors.second;
-
-                if(currentTotalWeight + neighborWeight < totalDistances[neighborName]){
-                    totalDistances[neighborName] = currentTotalWeight + neighborWeight;
-                    parent[neighborName] = currentName;
-                    dijkstraPQ.push(make_pair(currentTotalWeight + neighborWeight, neighborName));
+            forEachNeighbor(currentNode, [&](unsigned int neighbor, double neighborWeight){
+                if(currentTotalWeight + neighborWeight < totalDistances[neighbor]){
+                    totalDistances[neighbor] = currentTotalWeight + neighborWeight;
+                    parent[neighbor] = currentNode;
+                    singleEdgeWeights[neighbor] = neighborWeight;
+                    dijkstraPQ.push(make_pair(currentTotalWeight + neighborWeight, neighbor));
                 }
-            }
+            });
         }
     }
     
-    string endToStart = end_label;
-    while(endToStart.compare("") != 0){
-        string par = parent[endToStart];
-        if(!par.empty()){
-            //the adjacencyList[current][neighbor] = the edge weight 
-                path.push_back(make_tuple(par, endToStart, adjacencyList.at(endToStart).at(par)));
-        }
-        endToStart = parent[endToStart];
+    unsigned int endToStart = end;
+    while(parent[endToStart] != NO_NODE){
+        unsigned int par = parent[endToStart];
+        path.push_back(make_tuple(labels[par], labels[endToStart], singleEdgeWeights[endToStart]));
+        endToStart = par;
     }
 
     if(!path.empty()){
@@ -218,35 +677,31 @@ vector<tuple<string,string,double>> Graph::shortest_path_weighted(string const &
 
 vector<vector<string>> Graph::connected_components(double const & threshold) {
     // TODO
-    queue<string> bfsQueue;
+    queue<unsigned int> bfsQueue;
     vector<vector<string>> allComponents;
-    set<string> visited; 
+    vector<bool> visited(labels.size(), false);
 
-    for(auto& pairing : adjacencyList){
-        string vertex = pairing.first;
+    for(unsigned int vertex = 0; vertex < labels.size(); ++vertex){
         
         //if it wasn't visited, perform BFS starting with that vertex
-        if(visited.find(vertex) == visited.end()){
+        if(!visited[vertex]){
             vector<string> elementsOneComponent;
             
             bfsQueue.push(vertex);
-            visited.insert(vertex);
-            elementsOneComponent.push_back(vertex);
+            visited[vertex] = true;
+            elementsOneComponent.push_back(labels[vertex]);
 
             while(!bfsQueue.empty()){
-                string currentNode = bfsQueue.front();
+                unsigned int currentNode = bfsQueue.front();
                 bfsQueue.pop();
 
-                for(auto& neighborAndEdge : adjacencyList.at(currentNode)){
-                    string neighborName = neighborAndEdge.first;
-                    double neighborWeight = neighborAndEdge.second;
-
-                    if(neighborWeight <= threshold && (visited.find(neighborName) == visited.end())){
-                        bfsQueue.push(neighborName);
-                        visited.insert(neighborName);
-                        elementsOneComponent.push_back(neighborName);
+                forEachNeighbor(currentNode, [&](unsigned int neighbor, double neighborWeight){
+                    if(neighborWeight <= threshold && !visited[neighbor]){
+                        bfsQueue.push(neighbor);
+                        visited[neighbor] = true;
+                        elementsOneComponent.push_back(labels[neighbor]);
                     }
-                }
+                });
             }
 
             //now add the elements to the vector of components
@@ -257,7 +712,7 @@ vector<vector<string>> Graph::connected_components(double const & threshold) {
     return allComponents;
 }
 
-bool tupleWeightComparator(tuple<string,string,double> first, tuple<string,string,double> second){
+bool tupleWeightComparator(tuple<unsigned int,unsigned int,double> const & first, tuple<unsigned int,unsigned int,double> const & second){
     double firstWeight = get<2>(first);
     double secondWeight = get<2>(second);
 
@@ -265,51 +720,46 @@ bool tupleWeightComparator(tuple<string,string,double> first, tuple<string,strin
         return firstWeight < secondWeight;
     }
     
-    string firstNeighbor = get<1>(first);
-    string secondNeighbor = get<1>(second);
-    if(firstNeighbor.compare(secondNeighbor) != 0){
-        return (firstNeighbor.compare(secondNeighbor) < 0);
+    if(get<0>(first) != get<0>(second)){
+        return get<0>(first) < get<0>(second);
     }
 
-    string firstName = get<0>(first);
-    string secondName = get<0>(second);
-    return (firstName.compare(secondName) < 0);
+    return get<1>(first) < get<1>(second);
 }
 
 double Graph::smallest_connecting_threshold(string const & start_label, string const & end_label) {
     // TODO
-    vector<string> allNodes = nodes();
-    DisjointSet ds;
-    ds.makeSet(allNodes);
-    vector<tuple<string,string,double>> edgeTuple;
-
     if(start_label.compare(end_label) == 0){
         return 0;
     }
 
-    //getting all the edges into the vector
-    for(auto& currentAndList : adjacencyList){
-        string currentName = currentAndList.first;
-        for(pair<string, double> pairing : adjacencyList.at(currentName)){
-            string neighborName = pairing.first;
-            double neighborWeight = pairing.second;
-            edgeTuple.push_back(make_tuple(currentName, neighborName, neighborWeight));
-        }
+    auto foundStart = ids.find(start_label);
+    auto foundEnd = ids.find(end_label);
+    if(foundStart == ids.end() || foundEnd == ids.end()){
+        return -1;
+    }
+
+    DisjointSet ds;
+    ds.makeSet(labels.size());
+    vector<tuple<unsigned int,unsigned int,double>> edgeTuple;
+
+    //getting all the edges into the vector, once per undirected edge
+    for(unsigned int currentNode = 0; currentNode < labels.size(); ++currentNode){
+        forEachNeighbor(currentNode, [&](unsigned int neighbor, double neighborWeight){
+            if(currentNode < neighbor){
+                edgeTuple.push_back(make_tuple(currentNode, neighbor, neighborWeight));
+            }
+        });
     }
 
     //sort the edges by weight
     sort(edgeTuple.begin(), edgeTuple.end(), tupleWeightComparator);
 
     //add the nodes into a larger set to get the min edge weight
-    for(tuple<string,string,double> minEdge : edgeTuple){
-        string one = get<0>(minEdge);
-        string two = get<1>(minEdge);
-        ds.unionBySize(one,two);
+    for(tuple<unsigned int,unsigned int,double> const & minEdge : edgeTuple){
+        ds.unionBySize(get<0>(minEdge), get<1>(minEdge));
 
-        string argOneParent = ds.find(start_label);
-        string argTwoParent = ds.find(end_label);
-
-        if(argOneParent.compare(argTwoParent) == 0){
+        if(ds.find(foundStart->second) == ds.find(foundEnd->second)){
             //then they are in the same set
             double min = get<2>(minEdge);
             return min;
@@ -318,4 +768,4 @@ double Graph::smallest_connecting_threshold(string const & start_label, string c
     
     //unreachable, so return -1
     return -1;
-}
\ No newline at end of file
+}
@@ -1,5 +1,7 @@
 #ifndef GRAPH_H
 #define GRAPH_H
+#include <cstdint>
+#include <cstring>
 #include <string>
 #include <tuple>
 #include <vector>
@@ -18,70 +20,80 @@ using namespace std;
  */
 class Graph {
     public:
-        /** 
-         * A class that implements the Disjoint Set ADT. It creates a forest of nodes 
-         * so the scope of all the unions is in one object.
+        /**
+         * The vertex orderings that can be applied when a Graph is loaded. Every node is
+         * relabeled with an integer ID in the chosen order, so that nodes visited together
+         * sit close together in memory. The original string labels are kept for output.
+         * - `ORDER_NONE`: the order in which nodes first appear in the edge list.
+         * - `ORDER_DEGREE`: nodes sorted by decreasing degree, so hubs share cache lines.
+         * - `ORDER_RCM`: Reverse Cuthill-McKee, which keeps the bandwidth of the adjacency matrix small.
+         * - `ORDER_BFS`: the order in which a breadth-first traversal discovers the nodes.
+         * - `ORDER_GORDER`: a Gorder-style greedy ordering that places nodes sharing many neighbors within a small window.
          */
-        class DisjointSet{
-            private:
-                unordered_map<string, string> parent;
-                unordered_map<string, int> sizes;
+        enum Ordering { ORDER_NONE, ORDER_DEGREE, ORDER_RCM, ORDER_BFS, ORDER_GORDER };
 
-            public:
-                /**
-                 * Makes each node in the vector a disjoint set
-                 */
-                void makeSet(vector<string> & nodes){
-                    for(string node : nodes){
-                        parent[node] = node;
-                        sizes[node] = 1;
-                    }
-                }
-                /**
-                * Finds the sentinel of the set you are in, and compresses
-                * the path of the nodes you visited along the way.
-                * @return The sentinel node of the set.
-                */
-                string find(string node){
-                    vector<string> compressPaths;
-                    while(parent[node].compare(node) != 0){
-                        compressPaths.push_back(node);
-                        node = parent[node];
-                    }
-                    for(string child : compressPaths){
-                        parent[child] = node;
-                    }
-                    return node;
-                }
-                /** 
-                 * Unions two sets based on their sizes, and increments the 
-                 * larger set by its child.
-                 */
-                void unionBySize(string first, string second){
-                    string firstSen = find(first);
-                    string secondSen = find(second);
+        /**
+         * The ways the adjacency can be stored once a Graph is loaded. Every mode other than
+         * `COMPRESS_NONE` makes the graph read-only in a smaller form: each neighbor list is
+         * sorted and gap-encoded as varints.
+         * - `COMPRESS_NONE`: plain neighbor IDs and `double` weights.
+         * - `COMPRESS_VARINT`: varint neighbor gaps with exact `double` weights.
+         * - `COMPRESS_VARINT_Q32`: varint neighbor gaps with weights quantized to 32 bits.
+         * - `COMPRESS_VARINT_Q16`: varint neighbor gaps with weights quantized to 16 bits.
+         * Quantized weights are within `max_weight_error()` of the weights in the edge list.
+         */
+        enum Compression { COMPRESS_NONE, COMPRESS_VARINT, COMPRESS_VARINT_Q32, COMPRESS_VARINT_Q16 };
 
-                    if(firstSen.compare(secondSen) == 0){
-                        return;
-                    }
+        /**
+         * Look up an ordering by its name ("none", "degree", "rcm", "bfs", or "gorder").
+         * @param name The name of the ordering.
+         * @param ordering Set to the matching ordering if one exists.
+         * @return `true` if `name` names an ordering, otherwise `false`.
+         */
+        static bool parse_ordering(string const & name, Ordering & ordering);
 
-                    if(sizes[firstSen] >= sizes[secondSen]){
-                        parent[secondSen] = firstSen;
-                        sizes[firstSen] += sizes[secondSen];
-                    }
-                    else if(sizes[firstSen] < sizes[secondSen]){
-                        parent[firstSen] = secondSen;
-                        sizes[secondSen] += sizes[firstSen];
-                    }
-                }
-        };
+        /**
+         * Return the name of a given ordering, as accepted by `parse_ordering`.
+         * @param ordering The ordering.
+         * @return The name of `ordering`.
+         */
+        static string ordering_name(Ordering ordering);
+
+        /**
+         * Look up a compression mode by its name ("none", "varint", "q32", or "q16").
+         * @param name The name of the compression mode.
+         * @param compression Set to the matching compression mode if one exists.
+         * @return `true` if `name` names a compression mode, otherwise `false`.
+         */
+        static bool parse_compression(string const & name, Compression & compression);
+
+        /**
+         * Return the name of a given compression mode, as accepted by `parse_compression`.
+         * @param compression The compression mode.
+         * @return The name of `compression`.
+         */
+        static string compression_name(Compression compression);
 
-        unordered_map<string, unordered_map<string,double>> adjacencyList;
         /**
          * Initialize a Graph object from a given edge list CSV, where each line `u,v,w` represents an edge between nodes `u` and `v` with weight `w`.
          * @param edgelist_csv_fn The filename of an edge list from which to load the Graph.
+         * @param ordering The order in which to lay out the nodes in memory.
+         * @param compression How to store the adjacency once the graph is loaded.
          */
-        Graph(const char* const & edgelist_csv_fn);
+        Graph(const char* const & edgelist_csv_fn, Ordering ordering = ORDER_NONE, Compression compression = COMPRESS_NONE);
+
+        /**
+         * Return the number of bytes used to store the adjacency (neighbor IDs, weights, and row offsets), not counting node labels.
+         * @return The number of bytes used to store the adjacency of this graph.
+         */
+        size_t adjacency_bytes();
+
+        /**
+         * Return the largest difference between an edge weight returned by this graph and the weight in the edge list.
+         * This is 0 unless the weights are quantized.
+         * @return The largest possible error of a stored edge weight.
+         */
+        double max_weight_error();
 
         /**
          * Return the number of nodes in this graph.
@@ -90,8 +102,8 @@ class Graph {
         unsigned int num_nodes();
 
         /**
-         * Return a `vector` of node labels of all nodes in this graph, in any order.
-         * @return A `vector` containing the labels of all nodes in this graph, in any order.
+         * Return a `vector` of node labels of all nodes in this graph, in the order chosen when the graph was loaded.
+         * @return A `vector` containing the labels of all nodes in this graph, in the order chosen when the graph was loaded.
          */
         vector<string> nodes();
 
@@ -169,5 +181,185 @@ class Graph {
          * @return The smallest `threshold` such that, if we only considered all edges with weights <= `threshold, there would exist a path connecting the nodes labeled by `start_label` and `end_label`, or -1 if no such threshold exists.
          */
         double smallest_connecting_threshold(string const & start_label, string const & end_label);
+
+    private:
+        /** 
+         * A class that implements the Disjoint Set ADT. It creates a forest of nodes 
+         * so the scope of all the unions is in one object.
+         */
+        class DisjointSet{
+            private:
+                vector<unsigned int> parent;
+                vector<unsigned int> sizes;
+
+            public:
+                /**
+                 * Makes each of the nodes `0` to `numNodes - 1` a disjoint set
+                 */
+                void makeSet(unsigned int numNodes){
+                    parent.resize(numNodes);
+                    sizes.assign(numNodes, 1);
+                    for(unsigned int node = 0; node < numNodes; ++node){
+                        parent[node] = node;
+                    }
+                }
+                /**
+                * Finds the sentinel of the set you are in, and compresses
+                * the path of the nodes you visited along the way.
+                * @return The sentinel node of the set.
+                */
+                unsigned int find(unsigned int node){
+                    vector<unsigned int> compressPaths;
+                    while(parent[node] != node){
+                        compressPaths.push_back(node);
+                        node = parent[node];
+                    }
+                    for(unsigned int child : compressPaths){
+                        parent[child] = node;
+                    }
+                    return node;
+                }
+                /** 
+                 * Unions two sets based on their sizes, and increments the 
+                 * larger set by its child.
+                 */
+                void unionBySize(unsigned int first, unsigned int second){
+                    unsigned int firstSen = find(first);
+                    unsigned int secondSen = find(second);
+
+                    if(firstSen == secondSen){
+                        return;
+                    }
+
+                    if(sizes[firstSen] >= sizes[secondSen]){
+                        parent[secondSen] = firstSen;
+                        sizes[firstSen] += sizes[secondSen];
+                    }
+                    else if(sizes[firstSen] < sizes[secondSen]){
+                        parent[firstSen] = secondSen;
+                        sizes[secondSen] += sizes[firstSen];
+                    }
+                }
+        };
+
+        /**
+         * One direction of an edge while the graph is being loaded.
+         */
+        struct Edge {
+            unsigned int from;
+            unsigned int to;
+            double weight;
+        };
+
+        /**
+         * Order edges by `from`, then by `to`.
+         */
+        static bool edgeLess(Edge const & first, Edge const & second);
+
+        /**
+         * Sort edges with `edgeLess` and keep only the last weight given for each pair of endpoints.
+         */
+        static void sortEdges(vector<Edge> & edges);
+
+        vector<string> labels;                      //the label of each node ID
+        unordered_map<string, unsigned int> ids;    //the node ID of each label
+
+        /**
+         * The adjacency of the relabeled graph in compressed sparse row form: the neighbors
+         * of node `u` are `targets[offsets[u]]` to `targets[offsets[u+1] - 1]`, sorted by ID,
+         * and `weights` holds the matching edge weights.
+         */
+        vector<unsigned int> offsets;
+        vector<unsigned int> targets;
+        vector<double> weights;
+
+        /**
+         * The compressed adjacency. `targets` and `weights` are left empty, and `offsets[u]` is instead
+         * the byte offset of node `u`'s row in `encodedNeighbors`, so the encoded adjacency is limited to
+         * 4 GB. Each neighbor is a varint followed by its weight: the first varint is the zigzag-encoded
+         * difference from `u` and each later one is the gap from the previous neighbor. The weight is an
+         * 8-byte `double`, or a 4 or 2 byte level `q` that stands for `weightBase + q * weightStep`.
+         */
+        Compression compression;
+        vector<unsigned char> encodedNeighbors;
+        double weightBase;
+        double weightStep;
+        unsigned int edgeCount;                     //the number of undirected edges
+
+        /**
+         * Lay out the adjacency from edges sorted with `edgeLess`, encoding each row directly
+         * in the given form so the plain form is never built for a compressed graph.
+         */
+        void buildRows(vector<Edge> const & edges, Compression mode);
+
+        /**
+         * Decode the varint at `bytes` and advance `bytes` past it.
+         */
+        static unsigned int decodeVarint(const unsigned char* & bytes) {
+            unsigned int value = 0;
+            unsigned int shift = 0;
+            while(*bytes & 0x80){
+                value |= static_cast<unsigned int>(*bytes++ & 0x7f) << shift;
+                shift += 7;
+            }
+            return value | (static_cast<unsigned int>(*bytes++) << shift);
+        }
+
+        /**
+         * Decode the next neighbor of node `u` from its compressed row, given the `previous`
+         * neighbor, and advance `bytes` past it.
+         */
+        static unsigned int nextNeighbor(unsigned int u, bool firstInRow, unsigned int previous, const unsigned char* & bytes) {
+            unsigned int gap = decodeVarint(bytes);
+            if(firstInRow){
+                //zigzag: even values are forward differences, odd values are backward
+                return (gap & 1) ? u - (gap >> 1) - 1 : u + (gap >> 1);
+            }
+            return previous + gap;
+        }
+
+        /**
+         * Decode the weight stored at `bytes` in a compressed row and advance `bytes` past it.
+         */
+        double nextWeight(const unsigned char* & bytes) const {
+            if(compression == COMPRESS_VARINT_Q16){
+                uint16_t level;
+                memcpy(&level, bytes, sizeof(level));
+                bytes += sizeof(level);
+                return weightBase + level * weightStep;
+            }
+            if(compression == COMPRESS_VARINT_Q32){
+                uint32_t level;
+                memcpy(&level, bytes, sizeof(level));
+                bytes += sizeof(level);
+                return weightBase + level * weightStep;
+            }
+            double weight;
+            memcpy(&weight, bytes, sizeof(weight));
+            bytes += sizeof(weight);
+            return weight;
+        }
+
+        /**
+         * Call `visit(neighbor, weight)` for each neighbor of the node with ID `u`, in order of ID.
+         */
+        template<typename Visit>
+        void forEachNeighbor(unsigned int u, Visit visit) const {
+            if(compression == COMPRESS_NONE){
+                for(unsigned int i = offsets[u]; i < offsets[u+1]; ++i){
+                    visit(targets[i], weights[i]);
+                }
+                return;
+            }
+
+            const unsigned char* bytes = encodedNeighbors.data() + offsets[u];
+            const unsigned char* rowEnd = encodedNeighbors.data() + offsets[u+1];
+            unsigned int neighbor = u;
+            for(bool firstInRow = true; bytes < rowEnd; firstInRow = false){
+                neighbor = nextNeighbor(u, firstInRow, neighbor, bytes);
+                double weight = nextWeight(bytes);
+                visit(neighbor, weight);
+            }
+        }
 };
 #endif
\ No newline at end of file
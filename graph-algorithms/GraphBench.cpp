@@ -0,0 +1,181 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+#include "Graph.h"
+using namespace std;
+
+// default number of random (start,end) queries per algorithm
+#ifndef NUM_QUERIES
+#define NUM_QUERIES 100
+#endif
+
+/**
+ * A hardware event counter for the calling thread, read through `perf_event_open`.
+ * If the kernel does not allow the counter (e.g. in a container or VM), or the program
+ * is not built on Linux, `stop` returns -1.
+ */
+class PerfCounter {
+    private:
+        int fd;
+
+    public:
+#ifdef __linux__
+        PerfCounter(unsigned long long config) {
+            struct perf_event_attr attr;
+            memset(&attr, 0, sizeof(attr));
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.size = sizeof(attr);
+            attr.config = config;
+            attr.disabled = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            fd = syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+        }
+
+        ~PerfCounter() {
+            if(fd >= 0) { close(fd); }
+        }
+
+        void start() {
+            if(fd >= 0) {
+                ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+                ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+            }
+        }
+
+        long long stop() {
+            long long count = -1;
+            if(fd >= 0) {
+                ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+                if(read(fd, &count, sizeof(count)) != sizeof(count)) { count = -1; }
+            }
+            return count;
+        }
+#else
+        PerfCounter(unsigned long long) : fd(-1) {}
+        void start() {}
+        long long stop() { return -1; }
+#endif
+};
+
+// the events counted by each phase
+#ifdef __linux__
+const unsigned long long CACHE_MISSES = PERF_COUNT_HW_CACHE_MISSES;
+const unsigned long long CACHE_REFERENCES = PERF_COUNT_HW_CACHE_REFERENCES;
+#else
+const unsigned long long CACHE_MISSES = 0;
+const unsigned long long CACHE_REFERENCES = 0;
+#endif
+
+/**
+ * Times one phase of the benchmark and counts its cache references and misses.
+ */
+class Phase {
+    private:
+        PerfCounter misses;
+        PerfCounter references;
+        chrono::steady_clock::time_point begin;
+
+    public:
+        Phase() : misses(CACHE_MISSES), references(CACHE_REFERENCES) {
+            references.start(); misses.start();
+            begin = chrono::steady_clock::now();
+        }
+
+        /**
+         * Stop the phase and print one row of the results table.
+         */
+        void report(string const & config, string const & name) {
+            chrono::steady_clock::time_point end = chrono::steady_clock::now();
+            long long missCount = misses.stop(); long long referenceCount = references.stop();
+            double ms = chrono::duration<double, milli>(end - begin).count();
+            cout << left << setw(16) << config << setw(22) << name << right << setw(12) << fixed << setprecision(3) << ms;
+            if(missCount < 0 || referenceCount < 0) { cout << setw(16) << "n/a" << setw(16) << "n/a"; }
+            else { cout << setw(16) << missCount << setw(16) << referenceCount; }
+            cout << endl;
+        }
+};
+
+// main GraphBench program execution
+int main(int argc, char** argv) {
+    // check user args
+    if(argc != 2 && argc != 3) {
+        cerr << "USAGE: " << argv[0] << " <edgelist_csv> [num_queries]" << endl; exit(1);
+    }
+    unsigned int numQueries = (argc == 3) ? atoi(argv[2]) : NUM_QUERIES;
+
+    // find the range of the edge weights for the connected components sweep
+    Graph plain(argv[1]);
+    vector<string> labels = plain.nodes();
+    if(labels.empty()) {
+        cerr << "Empty graph: " << argv[1] << endl; exit(1);
+    }
+    double minWeight = numeric_limits<double>::max(); double maxWeight = 0;
+    for(string const & u : labels) {
+        for(string const & v : plain.neighbors(u)) {
+            minWeight = min(minWeight, plain.edge_weight(u,v)); maxWeight = max(maxWeight, plain.edge_weight(u,v));
+        }
+    }
+
+    // pick the queries from the sorted labels so that every ordering answers the same ones
+    sort(labels.begin(), labels.end());
+    mt19937 rng(42);
+    uniform_int_distribution<size_t> pick(0, labels.size() - 1);
+    vector<pair<string,string>> queries;
+    for(unsigned int i = 0; i < numQueries; ++i) {
+        queries.push_back(make_pair(labels[pick(rng)], labels[pick(rng)]));
+    }
+
+    cout << left << setw(16) << "order/storage" << setw(22) << "phase" << right << setw(12) << "time (ms)" << setw(16) << "cache-misses" << setw(16) << "cache-refs" << endl;
+    for(int i = Graph::ORDER_NONE; i <= Graph::ORDER_GORDER; ++i) {
+        for(int j = Graph::COMPRESS_NONE; j <= Graph::COMPRESS_VARINT_Q16; ++j) {
+            Graph::Ordering ordering = static_cast<Graph::Ordering>(i);
+            Graph::Compression compression = static_cast<Graph::Compression>(j);
+            string name = Graph::ordering_name(ordering) + '/' + Graph::compression_name(compression);
+
+            Phase load;
+            Graph g(argv[1], ordering, compression);
+            load.report(name, "load");
+
+            // the checksum keeps the queries from being optimized away
+            size_t checksum = 0;
+            Phase bfs;
+            for(pair<string,string> const & query : queries) { checksum += g.shortest_path_unweighted(query.first, query.second).size(); }
+            bfs.report(name, "shortest_unweighted");
+
+            Phase dijkstra;
+            for(pair<string,string> const & query : queries) { checksum += g.shortest_path_weighted(query.first, query.second).size(); }
+            dijkstra.report(name, "shortest_weighted");
+
+            // sweep the components threshold from the smallest to the largest edge weight
+            Phase components;
+            for(unsigned int q = 0; q < numQueries; ++q) {
+                double threshold = minWeight + (maxWeight - minWeight) * q / max(1u, numQueries - 1);
+                checksum += g.connected_components(threshold).size();
+            }
+            components.report(name, "connected_components");
+
+            Phase threshold;
+            for(pair<string,string> const & query : queries) { checksum += g.smallest_connecting_threshold(query.first, query.second) >= 0; }
+            threshold.report(name, "smallest_threshold");
+
+            cout << left << setw(16) << name << "bytes/edge " << setprecision(2) << g.adjacency_bytes() / double(g.num_edges())
+                 << "  max weight error " << scientific << g.max_weight_error() << defaultfloat << "  checksum " << checksum << endl;
+        }
+    }
+
+    // finished
+    return 0;
+}
@@ -31,8 +31,24 @@ const unordered_set<string> TESTS(TESTS_ORDERED, TESTS_ORDERED+sizeof(TESTS_ORDE
 // main GraphTest program execution
 int main(int argc, char** argv) {
     // check user args
-    if(argc != 3) {
-        cerr << "USAGE: " << argv[0] << " <edgelist_csv> <test>" << endl; exit(1);
+    Graph::Ordering ordering = Graph::ORDER_NONE;
+    Graph::Compression compression = Graph::COMPRESS_NONE;
+    if(argc < 3 || argc > 5) {
+        cerr << "USAGE: " << argv[0] << " <edgelist_csv> <test> [ordering] [compression]" << endl; exit(1);
+    } else if(argc >= 4 && !Graph::parse_ordering(argv[3], ordering)) {
+        cerr << "Invalid ordering: " << argv[3] << endl;
+        cerr << "Valid options:" << endl;
+        for(int i = Graph::ORDER_NONE; i <= Graph::ORDER_GORDER; ++i) {
+            cerr << "* " << Graph::ordering_name(static_cast<Graph::Ordering>(i)) << endl;
+        }
+        exit(1);
+    } else if(argc == 5 && !Graph::parse_compression(argv[4], compression)) {
+        cerr << "Invalid compression: " << argv[4] << endl;
+        cerr << "Valid options:" << endl;
+        for(int i = Graph::COMPRESS_NONE; i <= Graph::COMPRESS_VARINT_Q16; ++i) {
+            cerr << "* " << Graph::compression_name(static_cast<Graph::Compression>(i)) << endl;
+        }
+        exit(1);
     } else if(TESTS.find(argv[2]) == TESTS.end()) {
         cerr << "Invalid test: " << argv[2] << endl;
         cerr << "Valid options:" << endl;
@@ -43,7 +59,7 @@ int main(int argc, char** argv) {
     }
 
     // load graph and perform tests
-    Graph g(argv[1]);
+    Graph g(argv[1], ordering, compression);
     vector<string> nodes = g.nodes();
 
     // check basic properties of the graph